@@ -3,6 +3,10 @@
 
 #include "Character/CharacterBase.h"
 #include "GameFramework/CharacterMovementComponent.h"
+#include "Components/SkeletalMeshComponent.h"
+#include "GameFramework/PlayerController.h"
+#include "Engine/World.h"
+#include "Engine/DemoNetDriver.h"
 
 // Sets default values
 ACharacterBase::ACharacterBase()
@@ -17,6 +21,15 @@ void ACharacterBase::BeginPlay()
 {
 	Super::BeginPlay();
 
+	// 初始使用普通频率，之后由 UpdateAdaptiveNetFrequency 在服务器上动态调整；
+	// 放在 BeginPlay 中以读取蓝图子类覆盖后的值
+	if (HasAuthority())
+	{
+		SetNetUpdateFrequency(NormalNetUpdateFrequency);
+		SetMinNetUpdateFrequency(FarNetUpdateFrequency);
+	}
+
+	PrevSimLocation = SimLocation = GetActorLocation();
 }
 
 // Called every frame
@@ -24,6 +37,23 @@ void ACharacterBase::Tick(float DeltaTime)
 {
 	Super::Tick(DeltaTime);
 
+	if (bUseFixedTickSimulation)
+	{
+		TickFixedSimulation(DeltaTime);
+	}
+	else
+	{
+		UpdateMovementState();
+	}
+
+	if (HasAuthority() && GetNetMode() != NM_Standalone)
+	{
+		UpdateAdaptiveNetFrequency(DeltaTime);
+	}
+}
+
+void ACharacterBase::UpdateMovementState()
+{
 	// 在基类中统一更新通用运动状态，所有子类（玩家、敌人）都可复用
 	const FVector Velocity = GetVelocity();
 	const FVector HorizontalVelocity(Velocity.X, Velocity.Y, 0.f);
@@ -35,3 +65,185 @@ void ACharacterBase::Tick(float DeltaTime)
 	}
 }
 
+void ACharacterBase::TickFixedSimulation(float DeltaTime)
+{
+	// 是否本地控制可能在 BeginPlay 之后才确定（占有/取消占有），每帧检查
+	SetDriveMovementFixedStep(IsLocallyControlled());
+
+	const float FixedDeltaTime = 1.0f / FixedSimTickRate;
+
+	SimTimeAccumulator += DeltaTime;
+
+	int32 Steps = 0;
+	while (SimTimeAccumulator >= FixedDeltaTime && Steps < MaxSimStepsPerFrame)
+	{
+		SimulateFixedStep(FixedDeltaTime);
+		SimTimeAccumulator -= FixedDeltaTime;
+		++Steps;
+	}
+
+	// 追赶不上时丢弃多余时间，而不是在后续帧里继续补
+	if (Steps == MaxSimStepsPerFrame)
+	{
+		SimTimeAccumulator = FMath::Min(SimTimeAccumulator, FixedDeltaTime);
+	}
+
+	InterpolateSimState(SimTimeAccumulator / FixedDeltaTime);
+}
+
+void ACharacterBase::SetDriveMovementFixedStep(bool bDrive)
+{
+	if (bDrive == bDrivingMovementFixedStep)
+	{
+		return;
+	}
+	bDrivingMovementFixedStep = bDrive;
+
+	// 由固定步驱动时关闭移动组件的自动 Tick，避免每个渲染帧都模拟一次并发送一次移动
+	if (UCharacterMovementComponent* MoveComp = GetCharacterMovement())
+	{
+		MoveComp->SetComponentTickEnabled(!bDrive);
+	}
+
+	// 重新开始插值，并把 Mesh 恢复到默认偏移
+	PrevSimLocation = SimLocation = GetActorLocation();
+	SimVisualOffset = FVector::ZeroVector;
+	if (USkeletalMeshComponent* MeshComp = GetMesh())
+	{
+		MeshComp->SetRelativeLocation(GetBaseTranslationOffset());
+	}
+}
+
+void ACharacterBase::SimulateFixedStep(float FixedDeltaTime)
+{
+	PrevSimGroundSpeed = SimGroundSpeed;
+
+	if (bDrivingMovementFixedStep)
+	{
+		// 以固定步长推进一次移动组件：消费本步的输入向量，并按固定间隔打包发送给服务器
+		if (UCharacterMovementComponent* MoveComp = GetCharacterMovement())
+		{
+			MoveComp->TickComponent(FixedDeltaTime, LEVELTICK_All, &MoveComp->PrimaryComponentTick);
+		}
+
+		PrevSimLocation = SimLocation;
+		SimLocation = GetActorLocation();
+	}
+
+	UpdateMovementState();
+	SimGroundSpeed = GroundSpeed;
+}
+
+void ACharacterBase::InterpolateSimState(float Alpha)
+{
+	GroundSpeed = FMath::Lerp(PrevSimGroundSpeed, SimGroundSpeed, Alpha);
+
+	if (!bDrivingMovementFixedStep)
+	{
+		return;
+	}
+
+	// 胶囊体按固定步长跳变，Mesh 在上一步与当前步之间插值显示；
+	// 两步之间位移过大（传送、服务器纠正）时直接对齐，不做插值
+	constexpr float MaxInterpolationDistance = 200.0f;
+	SimVisualOffset = FVector::DistSquared(PrevSimLocation, SimLocation) > FMath::Square(MaxInterpolationDistance)
+		? FVector::ZeroVector
+		: FMath::Lerp(PrevSimLocation, SimLocation, Alpha) - SimLocation;
+
+	if (USkeletalMeshComponent* MeshComp = GetMesh())
+	{
+		MeshComp->SetRelativeLocation(GetBaseTranslationOffset() + GetActorQuat().UnrotateVector(SimVisualOffset));
+	}
+}
+
+void ACharacterBase::MarkNetActivity()
+{
+	LastNetActivityTime = GetWorld()->GetTimeSeconds();
+
+	// 立即切到高频，不等下一次评估
+	NetFrequencyEvalAccumulator = NetFrequencyEvalInterval;
+}
+
+void ACharacterBase::UpdateAdaptiveNetFrequency(float DeltaTime)
+{
+	if (!bUseAdaptiveNetUpdateFrequency)
+	{
+		return;
+	}
+
+	NetFrequencyEvalAccumulator += DeltaTime;
+	if (NetFrequencyEvalAccumulator < NetFrequencyEvalInterval)
+	{
+		return;
+	}
+	NetFrequencyEvalAccumulator = 0.0f;
+
+	const float DesiredFrequency = ComputeDesiredNetUpdateFrequency();
+	const float CurrentFrequency = GetNetUpdateFrequency();
+	if (FMath::IsNearlyEqual(DesiredFrequency, CurrentFrequency))
+	{
+		return;
+	}
+
+	SetNetUpdateFrequency(DesiredFrequency);
+
+	// 从低频切到高频时，下一次更新时间可能还停留在低频的间隔上，强制尽快复制一次
+	if (DesiredFrequency > CurrentFrequency)
+	{
+		ForceNetUpdate();
+	}
+}
+
+float ACharacterBase::ComputeDesiredNetUpdateFrequency() const
+{
+	const bool bRecentlyActive = GetWorld()->GetTimeSeconds() - LastNetActivityTime < NetActivityHoldTime;
+	const bool bActive = bRecentlyActive || bIsInAir || GroundSpeed > FastMoveSpeedThreshold;
+
+	// 离所有观察者都很远时优先降频：远处观察者看不清细节，
+	// 活跃状态最多提升到普通频率，不会提升到活跃频率
+	if (IsFarFromAllViewers())
+	{
+		return bActive ? NormalNetUpdateFrequency : FarNetUpdateFrequency;
+	}
+
+	if (bActive)
+	{
+		return ActiveNetUpdateFrequency;
+	}
+
+	return GroundSpeed > KINDA_SMALL_NUMBER ? NormalNetUpdateFrequency : IdleNetUpdateFrequency;
+}
+
+bool ACharacterBase::IsFarFromAllViewers() const
+{
+	const FVector MyLocation = GetActorLocation();
+	const float FarDistSq = FMath::Square(FarViewerDistance);
+
+	for (FConstPlayerControllerIterator It = GetWorld()->GetPlayerControllerIterator(); It; ++It)
+	{
+		const APlayerController* PC = It->Get();
+		if (!PC || PC == GetController() || !PC->Player)
+		{
+			continue;
+		}
+
+		// 回放录制的观察者控制器不是真实玩家，不参与距离判断（监听服务器的本地玩家没有连接，仍需计入）
+		const UNetConnection* Connection = PC->GetNetConnection();
+		if (Connection && Connection->GetDriver() && Connection->GetDriver()->IsA<UDemoNetDriver>())
+		{
+			continue;
+		}
+
+		// 使用视点而不是 Pawn 位置，观战/等待重生的玩家也能正确判断
+		FVector ViewLocation;
+		FRotator ViewRotation;
+		PC->GetPlayerViewPoint(ViewLocation, ViewRotation);
+		if (FVector::DistSquared(ViewLocation, MyLocation) < FarDistSq)
+		{
+			return false;
+		}
+	}
+
+	return true;
+}
+
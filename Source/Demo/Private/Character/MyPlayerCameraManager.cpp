@@ -0,0 +1,89 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "Character/MyPlayerCameraManager.h"
+
+void AMyPlayerCameraManager::UpdateViewTargetInternal(FTViewTarget& OutVT, float DeltaTime)
+{
+	APlayerCharacter* PlayerCharacter = Cast<APlayerCharacter>(OutVT.Target);
+
+	// 视图目标变化（重生、观战）时丢弃旧的栈
+	if (PlayerCharacter != StackOwner.Get())
+	{
+		CameraModeStack.Reset();
+		StackOwner = PlayerCharacter;
+	}
+
+	// 非玩家角色仍走引擎默认的 CalcCamera 逻辑
+	if (!PlayerCharacter)
+	{
+		Super::UpdateViewTargetInternal(OutVT, DeltaTime);
+		return;
+	}
+
+	const EViewMode DesiredMode = PlayerCharacter->GetViewMode();
+	if (CameraModeStack.Num() == 0 || CameraModeStack.Last().Mode != DesiredMode)
+	{
+		PushCameraMode(DesiredMode);
+	}
+
+	UpdateCameraModeStack(DeltaTime);
+
+	// 从栈底向上逐层混合，只计算栈中的模式
+	PlayerCharacter->ComputeCameraModeView(CameraModeStack[0].Mode, DeltaTime, OutVT.POV);
+	for (int32 Index = 1; Index < CameraModeStack.Num(); ++Index)
+	{
+		FMinimalViewInfo ModeView;
+		PlayerCharacter->ComputeCameraModeView(CameraModeStack[Index].Mode, DeltaTime, ModeView);
+		OutVT.POV.BlendViewInfo(ModeView, FMath::SmoothStep(0.0f, 1.0f, CameraModeStack[Index].BlendWeight));
+	}
+}
+
+void AMyPlayerCameraManager::PushCameraMode(EViewMode Mode)
+{
+	const int32 Num = CameraModeStack.Num();
+
+	// 混合途中切回上一个模式：交换栈顶两层并反转权重，视图保持连续
+	if (Num >= 2 && CameraModeStack[Num - 2].Mode == Mode)
+	{
+		const float PreviousTopWeight = CameraModeStack[Num - 1].BlendWeight;
+		CameraModeStack.Swap(Num - 2, Num - 1);
+		CameraModeStack[Num - 1].BlendWeight = 1.0f - PreviousTopWeight;
+		return;
+	}
+
+	const int32 ExistingIndex = CameraModeStack.IndexOfByPredicate([Mode](const FCameraModeEntry& Entry) { return Entry.Mode == Mode; });
+	if (ExistingIndex != INDEX_NONE)
+	{
+		CameraModeStack.RemoveAt(ExistingIndex);
+	}
+	else if (APlayerCharacter* PlayerCharacter = StackOwner.Get())
+	{
+		PlayerCharacter->SetCameraModeActive(Mode, true);
+	}
+
+	// 第一个模式没有可混合的对象，直接满权重
+	CameraModeStack.Add({ Mode, CameraModeStack.Num() == 0 ? 1.0f : 0.0f });
+}
+
+void AMyPlayerCameraManager::UpdateCameraModeStack(float DeltaTime)
+{
+	FCameraModeEntry& Top = CameraModeStack.Last();
+	Top.BlendWeight = CameraModeBlendTime > 0.0f
+		? FMath::Min(Top.BlendWeight + DeltaTime / CameraModeBlendTime, 1.0f)
+		: 1.0f;
+
+	// 栈顶完全混入后，下面的模式不再影响结果，移除并通知角色停用
+	if (Top.BlendWeight >= 1.0f && CameraModeStack.Num() > 1)
+	{
+		const int32 NumToRemove = CameraModeStack.Num() - 1;
+		if (APlayerCharacter* PlayerCharacter = StackOwner.Get())
+		{
+			for (int32 Index = 0; Index < NumToRemove; ++Index)
+			{
+				PlayerCharacter->SetCameraModeActive(CameraModeStack[Index].Mode, false);
+			}
+		}
+		CameraModeStack.RemoveAt(0, NumToRemove);
+	}
+}
@@ -8,6 +8,7 @@
 #include "InputMappingContext.h"
 #include "InputAction.h"
 #include "Character/PlayerCharacter.h"
+#include "Character/MyPlayerCameraManager.h"
 
 AMyPlayerController::AMyPlayerController()
 	: DefaultMappingContext(nullptr)
@@ -17,6 +18,8 @@ AMyPlayerController::AMyPlayerController()
 	, FireAction(nullptr) // 射击动作，由蓝图指定 InputAction
 	, ToggleViewAction(nullptr)
 {
+	// 使用相机模式栈处理第一/第三人称视图与切换混合
+	PlayerCameraManagerClass = AMyPlayerCameraManager::StaticClass();
 }
 
 void AMyPlayerController::BeginPlay()
@@ -85,7 +88,15 @@ void AMyPlayerController::OnMove(const FInputActionValue& Value)
 	// 使用缓存的玩家角色指针，避免每次都 Cast
 	if (CachedPlayerCharacter)
 	{
-		CachedPlayerCharacter->HandleMoveInput(Axis);
+		// 固定步长模式下输入由角色在每个模拟步采样，这里只记录
+		if (CachedPlayerCharacter->UsesFixedTickSimulation())
+		{
+			CachedPlayerCharacter->QueueMoveInput(Axis);
+		}
+		else
+		{
+			CachedPlayerCharacter->HandleMoveInput(Axis);
+		}
 	}
 }
 
@@ -7,6 +7,7 @@
 #include "GameFramework/SpringArmComponent.h"
 #include "GameFramework/CharacterMovementComponent.h"
 #include "DrawDebugHelpers.h"
+#include "Net/UnrealNetwork.h"
 
 APlayerCharacter::APlayerCharacter()
 {
@@ -40,7 +41,8 @@ void APlayerCharacter::BeginPlay()
 	Super::BeginPlay();
 
 	// 如果在蓝图中指定了默认枪类，则在游戏开始时生成并附加一把枪
-	if (DefaultGunClass)
+	// 只在服务器生成，客户端通过 CurrentGun 的复制拿到同一把枪，避免每端各生成一把本地枪
+	if (DefaultGunClass && HasAuthority())
 	{
 		FActorSpawnParameters SpawnParams;
 		SpawnParams.Owner = this;
@@ -49,39 +51,154 @@ void APlayerCharacter::BeginPlay()
 		AGun* SpawnedGun = GetWorld()->SpawnActor<AGun>(DefaultGunClass, FVector::ZeroVector, FRotator::ZeroRotator, SpawnParams);
 		if (SpawnedGun)
 		{
-			CurrentGun = SpawnedGun;
-			CurrentGun->InitializeOwner(this);
-
-			// 将枪附加到角色 Mesh 上的武器插槽（需在 SkeletalMesh 上预先创建名为 "Gun" 的 Socket）
-			if (USkeletalMeshComponent* MeshComp = GetMesh())
-			{
-				CurrentGun->AttachToComponent(MeshComp, FAttachmentTransformRules::SnapToTargetNotIncludingScale, TEXT("Gun"));
-			}
+			EquipGun(SpawnedGun);
 		}
 	}
 }
 
+void APlayerCharacter::GetLifetimeReplicatedProps(TArray<FLifetimeProperty>& OutLifetimeProps) const
+{
+	Super::GetLifetimeReplicatedProps(OutLifetimeProps);
+
+	DOREPLIFETIME(APlayerCharacter, CurrentGun);
+}
+
+void APlayerCharacter::EquipGun(AGun* NewGun)
+{
+	// 卸下旧枪：解除附着与所有者，恢复独立的移动复制与相关性，再唤醒一次把卸下后的状态复制出去
+	if (CurrentGun && CurrentGun != NewGun)
+	{
+		AGun* OldGun = CurrentGun;
+		OldGun->DetachFromActor(FDetachmentTransformRules::KeepWorldTransform);
+		OldGun->SetOwner(nullptr);
+		OldGun->bNetUseOwnerRelevancy = false;
+		OldGun->SetReplicateMovement(true);
+		OldGun->FlushNetDormancy();
+	}
+
+	CurrentGun = NewGun;
+	if (!CurrentGun)
+	{
+		return;
+	}
+
+	CurrentGun->InitializeOwner(this);
+
+	// 附着后枪的位置完全由角色 Mesh 决定：
+	// - 不再复制 ReplicatedMovement，客户端在 OnRep_CurrentGun 中自行附着
+	//   （AttachmentReplication 不受 SetReplicateMovement 控制，仍随枪复制，但只在唤醒时发送）
+	// - 相关性跟随角色，不再单独做距离判断
+	CurrentGun->SetReplicateMovement(false);
+	CurrentGun->bNetUseOwnerRelevancy = true;
+
+	// 将枪附加到角色 Mesh 上的武器插槽（需在 SkeletalMesh 上预先创建名为 "Gun" 的 Socket）
+	AttachGunToMesh(CurrentGun);
+
+	// 客户端只通过 CurrentGun 的复制拿到枪，枪本身必须是复制 Actor
+	CurrentGun->SetReplicates(true);
+
+	// 进入休眠：首次复制完成后不再参与每次网络更新的检查，
+	// 弹药/状态变化时由 FlushNetDormancy 唤醒一次后自动重新休眠
+	CurrentGun->SetNetDormancy(DORM_DormantAll);
+}
+
+void APlayerCharacter::AttachGunToMesh(AGun* Gun) const
+{
+	if (!Gun)
+	{
+		return;
+	}
+
+	if (USkeletalMeshComponent* MeshComp = GetMesh())
+	{
+		Gun->AttachToComponent(MeshComp, FAttachmentTransformRules::SnapToTargetNotIncludingScale, TEXT("Gun"));
+	}
+}
+
+void APlayerCharacter::OnRep_CurrentGun()
+{
+	// 客户端：根据角色复制下来的 CurrentGun 完成初始化与附着，与服务器上的 EquipGun 保持一致
+	if (CurrentGun)
+	{
+		CurrentGun->InitializeOwner(this);
+	}
+	AttachGunToMesh(CurrentGun);
+}
+
 void APlayerCharacter::Tick(float DeltaTime)
 {
 	Super::Tick(DeltaTime);
 
-	// 更新视角与角色朝向的偏差角度（控制器旋转相对角色旋转的差值）
-	if (Controller)
+	if (UsesFixedTickSimulation())
+	{
+		// 本帧的所有模拟步都已采样过输入，清零等待控制器下一帧写入；
+		// 本帧没有模拟步时保留输入，留给下一帧的模拟步
+		if (bPendingMoveInputSampled)
+		{
+			PendingMoveInput = FVector2D::ZeroVector;
+			bPendingMoveInputSampled = false;
+		}
+	}
+	else
+	{
+		// 更新视角与角色朝向的偏差角度（控制器旋转相对角色旋转的差值）
+		ComputeViewAngles(HorizontalAngle, VerticalAngle);
+	}
+
+	if ((bRestoreCameraBoomLag || bRestoreCameraBoomRotationLag) && GFrameCounter > CameraBoomLagRestoreFrame)
+	{
+		RestoreCameraBoomLag();
+	}
+
+	// 如果玩家有额外的 per-frame 逻辑，可以在此处补充。
+}
+
+bool APlayerCharacter::ComputeViewAngles(float& OutHorizontal, float& OutVertical) const
+{
+	if (!Controller)
 	{
-		const FRotator ControlRot = Controller->GetControlRotation();
-		const FRotator ActorRot   = GetActorRotation();
+		return false;
+	}
 
-		// 计算控制器相对于角色的旋转差值，并归一化到 [-180, 180] 区间
-		const FRotator DeltaRot = (ControlRot - ActorRot).GetNormalized();
+	const FRotator ControlRot = Controller->GetControlRotation();
+	const FRotator ActorRot   = GetActorRotation();
+
+	// 计算控制器相对于角色的旋转差值，并归一化到 [-180, 180] 区间
+	const FRotator DeltaRot = (ControlRot - ActorRot).GetNormalized();
 
-		// 水平角度：视线相对角色朝向的左右偏转（Yaw 差值），限制在 [-180, 180]
-		HorizontalAngle = FMath::ClampAngle(DeltaRot.Yaw, -180.0f, 180.0f);
+	// 水平角度：视线相对角色朝向的左右偏转（Yaw 差值），限制在 [-180, 180]
+	OutHorizontal = FMath::ClampAngle(DeltaRot.Yaw, -180.0f, 180.0f);
+
+	// 垂直角度：视线相对角色水平面的抬头/低头（Pitch 差值），同样做归一化限制
+	OutVertical = FMath::ClampAngle(DeltaRot.Pitch, -180.0f, 180.0f);
+	return true;
+}
 
-		// 垂直角度：视线相对角色水平面的抬头/低头（Pitch 差值），同样做归一化限制
-		VerticalAngle = FMath::ClampAngle(DeltaRot.Pitch, -180.0f, 180.0f);
+void APlayerCharacter::SimulateFixedStep(float FixedDeltaTime)
+{
+	// 每个模拟步采样一次控制器输入，并在移动组件推进本步之前施加
+	SampledMoveInput = PendingMoveInput;
+	bPendingMoveInputSampled = true;
+	if (IsLocallyControlled())
+	{
+		HandleMoveInput(SampledMoveInput);
 	}
 
-	// 如果玩家有额外的 per-frame 逻辑，可以在此处补充。
+	// 推进移动组件并更新运动状态
+	Super::SimulateFixedStep(FixedDeltaTime);
+
+	PrevSimHorizontalAngle = SimHorizontalAngle;
+	PrevSimVerticalAngle = SimVerticalAngle;
+	ComputeViewAngles(SimHorizontalAngle, SimVerticalAngle);
+}
+
+void APlayerCharacter::InterpolateSimState(float Alpha)
+{
+	Super::InterpolateSimState(Alpha);
+
+	// 按最短路径插值，避免在 ±180 度附近来回跳变
+	HorizontalAngle = PrevSimHorizontalAngle + FMath::UnwindDegrees(SimHorizontalAngle - PrevSimHorizontalAngle) * Alpha;
+	VerticalAngle = PrevSimVerticalAngle + FMath::UnwindDegrees(SimVerticalAngle - PrevSimVerticalAngle) * Alpha;
 }
 
 void APlayerCharacter::HandleMoveInput(const FVector2D& InputAxis)
@@ -138,7 +255,16 @@ void APlayerCharacter::HandleFireStarted()
 	// 如果已经装备了枪，优先通过枪来处理开火逻辑
 	if (CurrentGun)
 	{
-		CurrentGun->StartFire();
+		if (HasAuthority())
+		{
+			StartFireCurrentGun_Internal();
+		}
+		else
+		{
+			// 本地先调用一次用于开火表现（枪口特效、音效等），权威开火经由角色 RPC 在服务器执行
+			CurrentGun->StartFire();
+			Server_StartFireCurrentGun();
+		}
 		return;
 	}
 
@@ -167,6 +293,33 @@ void APlayerCharacter::HandleFireStopped()
 	// }
 }
 
+// ========= 枪开火：RPC 与内部实现 =========
+
+void APlayerCharacter::Server_StartFireCurrentGun_Implementation()
+{
+	if (!HasAuthority())
+	{
+		return;
+	}
+
+	StartFireCurrentGun_Internal();
+}
+
+void APlayerCharacter::StartFireCurrentGun_Internal()
+{
+	if (!CurrentGun)
+	{
+		return;
+	}
+
+	// 开火会改变弹药/状态：先唤醒枪，让这次变化复制出去，复制完成后枪会自动回到休眠
+	CurrentGun->FlushNetDormancy();
+	CurrentGun->StartFire();
+
+	// 开火期间提高角色的复制频率
+	MarkNetActivity();
+}
+
 // ========= 简易射击：RPC 与内部实现 =========
 
 void APlayerCharacter::Server_PerformSimpleFire_Implementation()
@@ -187,6 +340,8 @@ void APlayerCharacter::PerformSimpleFire_Internal()
 	// - 某个 AWeaponBase::PerformFire()
 	// - 或某个 UGameplayAbility::ActivateAbility() 中
 
+	MarkNetActivity();
+
 	// 1. 计算射线起点和方向：这里使用摄像机位置与朝向
 	const APlayerController* PC = Cast<APlayerController>(GetController());
 	if (!PC)
@@ -258,55 +413,77 @@ void APlayerCharacter::StartFireCurrentGun()
 
 void APlayerCharacter::ToggleViewMode()
 {
-	// 在第一/第三人称之间切换
-	if (CurrentViewMode == EViewMode::ThirdPerson)
+	// 只切换模式状态，不改动相机的附着关系和弹簧臂设置：
+	// 视图由 AMyPlayerCameraManager 根据当前模式计算，并在两种模式之间平滑混合
+	CurrentViewMode = (CurrentViewMode == EViewMode::ThirdPerson) ? EViewMode::FirstPerson : EViewMode::ThirdPerson;
+}
+
+void APlayerCharacter::ComputeCameraModeView(EViewMode Mode, float DeltaTime, FMinimalViewInfo& OutPOV) const
+{
+	// 第三人称：相机始终挂在弹簧臂末端，直接使用其视图（FOV、后处理等也从这里来）
+	if (FollowCamera)
+	{
+		FollowCamera->GetCameraView(DeltaTime, OutPOV);
+	}
+	else
 	{
-		CurrentViewMode = EViewMode::FirstPerson;
+		GetActorEyesViewPoint(OutPOV.Location, OutPOV.Rotation);
+	}
 
-		// 第一人称：缩短 SpringArm 长度，但主要依赖插槽来确定相机精确位置
-		if (CameraBoom)
-		{
-			CameraBoom->TargetArmLength = 0.f;
-			CameraBoom->bUsePawnControlRotation = false; // 让相机直接使用控制器旋转
-		}
+	// 固定步长模式下胶囊体按步跳变，弹簧臂随之跳变，叠加插值偏移与 Mesh 保持一致
+	OutPOV.Location += GetSimVisualOffset();
 
-		if (FollowCamera)
-		{
-			// 第一人称下，相机使用控制器旋转，角色本身不必跟随旋转
-			FollowCamera->bUsePawnControlRotation = true;
-
-			// 将相机从 SpringArm 上脱离，附着到角色 Mesh 的 "Camera" 插槽上
-			if (USkeletalMeshComponent* MeshComp = GetMesh())
-			{
-				// 这里假定你已经在角色头部的骨骼上创建了名为 "Camera" 的 Socket
-				FollowCamera->AttachToComponent(MeshComp, FAttachmentTransformRules::SnapToTargetNotIncludingScale, TEXT("Camera"));
-			}
-		}
+	if (Mode == EViewMode::FirstPerson)
+	{
+		// 第一人称：位置取角色 Mesh 上的 "Camera" 插槽（需在头部骨骼上预先创建）；
+		// 没有插槽时退回到眼睛位置（弹簧臂在第一人称下不再 Tick，不能用它的末端）
+		const USkeletalMeshComponent* MeshComp = GetMesh();
+		OutPOV.Location = (MeshComp && MeshComp->DoesSocketExist(TEXT("Camera")))
+			? MeshComp->GetSocketLocation(TEXT("Camera"))
+			: GetPawnViewLocation();
+
+		// 使用 Pawn 的视角旋转：没有控制器的角色（客户端上观战的远端角色）会使用复制下来的视角
+		OutPOV.Rotation = GetViewRotation();
+	}
+}
 
-		// 你当前不希望第一人称时角色跟着控制器转向：
-		// - 不再将 ActorRotation 强制对齐控制器 Yaw
-		// - 保持角色旋转由移动方向驱动（与第三人称一致）
-		bUseControllerRotationYaw = false;
+void APlayerCharacter::SetCameraModeActive(EViewMode Mode, bool bActive)
+{
+	// 第一人称只读取插槽，没有需要停用的组件；
+	// 第三人称不在相机栈中时停止弹簧臂的 Tick（碰撞检测与相机延迟）
+	if (Mode != EViewMode::ThirdPerson || !CameraBoom)
+	{
+		return;
 	}
-	else
+
+	CameraBoom->SetComponentTickEnabled(bActive);
+
+	if (!bActive)
 	{
-		CurrentViewMode = EViewMode::ThirdPerson;
+		// 停用期间若有未完成的恢复，先恢复原设置，避免把“已关闭”的状态当成原设置记下来
+		RestoreCameraBoomLag();
+		return;
+	}
 
-		// 第三人称：恢复 SpringArm 长度与旋转设置
-		if (CameraBoom)
-		{
-			CameraBoom->TargetArmLength = 300.f; // 可以根据需要调节，后续可提为配置
-			CameraBoom->bUsePawnControlRotation = true;
-		}
-		if (FollowCamera)
-		{
-			FollowCamera->bUsePawnControlRotation = false;
+	// 停用期间延迟的目标位置停留在进入第一人称时的位置，直接恢复会让相机从那里飞过来：
+	// 先关闭延迟，弹簧臂至少 Tick 一次对齐到当前位置后，再在 Tick 中恢复
+	bRestoreCameraBoomLag = CameraBoom->bEnableCameraLag;
+	bRestoreCameraBoomRotationLag = CameraBoom->bEnableCameraRotationLag;
+	CameraBoom->bEnableCameraLag = false;
+	CameraBoom->bEnableCameraRotationLag = false;
 
-			// 将相机重新附着回 SpringArm 末端，由 SpringArm 控制第三人称位置
-			FollowCamera->AttachToComponent(CameraBoom, FAttachmentTransformRules::SnapToTargetNotIncludingScale, USpringArmComponent::SocketName);
-		}
+	// 相机管理器在帧末激活模式，弹簧臂在下一帧才会 Tick，因此隔一帧再恢复
+	CameraBoomLagRestoreFrame = GFrameCounter + 1;
+}
 
-		// 第三人称：角色朝移动方向自动旋转，控制器只负责摄像机
-		bUseControllerRotationYaw = false;
+void APlayerCharacter::RestoreCameraBoomLag()
+{
+	if (CameraBoom)
+	{
+		CameraBoom->bEnableCameraLag |= bRestoreCameraBoomLag;
+		CameraBoom->bEnableCameraRotationLag |= bRestoreCameraBoomRotationLag;
 	}
+
+	bRestoreCameraBoomLag = false;
+	bRestoreCameraBoomRotationLag = false;
 }
@@ -3,6 +3,12 @@
 #include "GameMode/MyGameMode.h"
 #include "Character/PlayerCharacter.h"
 #include "Character/MyPlayerController.h"
+#include "Engine/GameInstance.h"
+#include "Engine/World.h"
+#include "EngineUtils.h"
+#include "HAL/FileManager.h"
+#include "HAL/IConsoleManager.h"
+#include "Misc/Paths.h"
 
 AMyGameMode::AMyGameMode()
 {
@@ -15,3 +21,121 @@ AMyGameMode::AMyGameMode()
 	// 说明：武器/射击逻辑完全在 PlayerController + PlayerCharacter 层处理，
 	// GameMode 不参与具体战斗逻辑，保持单一职责，便于扩展联机规则。
 }
+
+void AMyGameMode::HandleMatchHasStarted()
+{
+	Super::HandleMatchHasStarted();
+
+	StartMatchReplay();
+}
+
+void AMyGameMode::HandleMatchHasEnded()
+{
+	Super::HandleMatchHasEnded();
+
+	StopMatchReplay();
+}
+
+void AMyGameMode::EndPlay(const EEndPlayReason::Type EndPlayReason)
+{
+	// 对局未正常结束（关服/切图）时也要收尾，保证回放文件完整
+	StopMatchReplay();
+
+	Super::EndPlay(EndPlayReason);
+}
+
+void AMyGameMode::StartMatchReplay()
+{
+	// 只在专用服务器上录制，监听服务器/单机不承担录制开销
+	if (!bRecordMatchReplay || GetNetMode() != NM_DedicatedServer || !ActiveReplayName.IsEmpty())
+	{
+		return;
+	}
+
+	UWorld* World = GetWorld();
+	UGameInstance* GameInstance = GetGameInstance();
+	if (!World || !GameInstance)
+	{
+		return;
+	}
+
+	// 检查点间隔直接写入 DemoNetDriver 使用的 CVar
+	if (IConsoleVariable* CheckpointCVar = IConsoleManager::Get().FindConsoleVariable(TEXT("demo.CheckpointUploadDelayInSeconds")))
+	{
+		CheckpointCVar->Set(ReplayCheckpointInterval, ECVF_SetByGameSetting);
+	}
+
+	// 先处理已经存在的 Actor，再监听之后生成的 Actor；没有排除类时两者都跳过
+	if (ReplayExcludedActorClasses.Num() > 0)
+	{
+		for (TActorIterator<AActor> It(World); It; ++It)
+		{
+			ApplyReplayFilter(*It);
+		}
+		ActorSpawnedHandle = World->AddOnActorSpawnedHandler(FOnActorSpawned::FDelegate::CreateUObject(this, &AMyGameMode::OnActorSpawnedForReplay));
+	}
+
+	ActiveReplayName = FString::Printf(TEXT("Match_%s"), *FDateTime::Now().ToString());
+	ReplayStartTime = FPlatformTime::Seconds();
+	GameInstance->StartRecordingReplay(ActiveReplayName, ActiveReplayName);
+
+	UE_LOG(LogTemp, Log, TEXT("Replay recording started: %s (checkpoint interval %.1fs)"), *ActiveReplayName, ReplayCheckpointInterval);
+}
+
+void AMyGameMode::StopMatchReplay()
+{
+	if (ActiveReplayName.IsEmpty())
+	{
+		return;
+	}
+
+	if (UWorld* World = GetWorld())
+	{
+		World->RemoveOnActorSpawnedHandler(ActorSpawnedHandle);
+	}
+	ActorSpawnedHandle.Reset();
+
+	if (UGameInstance* GameInstance = GetGameInstance())
+	{
+		GameInstance->StopRecordingReplay();
+	}
+
+	// 输出录制时长与文件体积，用于评估每分钟回放大小。
+	// 本地文件流的收尾是异步的，此时文件可能尚未写完，体积只是近似值（偏小）
+	const double Minutes = (FPlatformTime::Seconds() - ReplayStartTime) / 60.0;
+	const FString ReplayFile = FPaths::Combine(FPaths::ProjectSavedDir(), TEXT("Demos"), ActiveReplayName + TEXT(".replay"));
+	const int64 FileSize = IFileManager::Get().FileSize(*ReplayFile);
+	if (FileSize > 0 && Minutes > 0.0)
+	{
+		UE_LOG(LogTemp, Log, TEXT("Replay recording stopped: %s, %.1f min, ~%.2f MB (~%.2f MB/min, approximate: file may still be finalizing)"),
+			*ActiveReplayName, Minutes, FileSize / (1024.0 * 1024.0), FileSize / (1024.0 * 1024.0) / Minutes);
+	}
+	else
+	{
+		UE_LOG(LogTemp, Log, TEXT("Replay recording stopped: %s, %.1f min"), *ActiveReplayName, Minutes);
+	}
+
+	ActiveReplayName.Reset();
+}
+
+void AMyGameMode::OnActorSpawnedForReplay(AActor* Actor)
+{
+	ApplyReplayFilter(Actor);
+}
+
+void AMyGameMode::ApplyReplayFilter(AActor* Actor) const
+{
+	if (!Actor)
+	{
+		return;
+	}
+
+	for (const TSubclassOf<AActor>& ExcludedClass : ReplayExcludedActorClasses)
+	{
+		if (ExcludedClass && Actor->IsA(ExcludedClass))
+		{
+			Actor->bRelevantForNetworkReplays = false;
+			return;
+		}
+	}
+}
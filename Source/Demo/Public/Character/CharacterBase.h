@@ -34,6 +34,101 @@ protected:
 	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category="Movement|State")
 	bool bIsInAir = false;
 
+	// ========= 固定步长模拟（可选） =========
+	// 开启后本地控制的角色由这里按固定频率驱动移动组件（关闭其自动 Tick），
+	// 客户端无论帧率高低都以固定步长模拟并以相同频率向服务器发送移动；
+	// 运动状态在每步更新，Mesh 位置与派生状态在渲染帧之间插值。
+	// 非本地控制的角色（服务器上的远端玩家、模拟代理）仍由移动组件按引擎默认方式更新
+
+	UPROPERTY(EditDefaultsOnly, Category="Movement|FixedTick")
+	bool bUseFixedTickSimulation = false;
+
+	// 模拟频率（Hz）
+	UPROPERTY(EditDefaultsOnly, Category="Movement|FixedTick", meta=(ClampMin="10.0", EditCondition="bUseFixedTickSimulation"))
+	float FixedSimTickRate = 60.0f;
+
+	// 单帧最多追赶的模拟步数，防止卡顿后出现“死亡螺旋”
+	UPROPERTY(EditDefaultsOnly, Category="Movement|FixedTick", meta=(ClampMin="1", EditCondition="bUseFixedTickSimulation"))
+	int32 MaxSimStepsPerFrame = 4;
+
+	// 每个固定步执行一次；子类在调用 Super 之前采样输入，Super 中推进移动组件
+	virtual void SimulateFixedStep(float FixedDeltaTime);
+
+	// 每个渲染帧执行一次；Alpha 为当前时间在上一步与下一步之间的比例
+	virtual void InterpolateSimState(float Alpha);
+
+	// 从移动组件读取速度/空中状态
+	void UpdateMovementState();
+
+	// ========= 自适应网络更新频率（仅服务器） =========
+	// 高速移动/空中/开火时提高复制频率，普通移动/静止时降低频率；
+	// 远离所有观察者时优先降频：不活跃时降到最低频率，活跃时最多使用普通频率
+
+	UPROPERTY(EditDefaultsOnly, Category="Network|Adaptive")
+	bool bUseAdaptiveNetUpdateFrequency = true;
+
+	// 活跃状态（高速移动、空中、刚开过火）
+	UPROPERTY(EditDefaultsOnly, Category="Network|Adaptive", meta=(ClampMin="1.0"))
+	float ActiveNetUpdateFrequency = 60.0f;
+
+	// 普通移动
+	UPROPERTY(EditDefaultsOnly, Category="Network|Adaptive", meta=(ClampMin="1.0"))
+	float NormalNetUpdateFrequency = 30.0f;
+
+	// 静止
+	UPROPERTY(EditDefaultsOnly, Category="Network|Adaptive", meta=(ClampMin="1.0"))
+	float IdleNetUpdateFrequency = 10.0f;
+
+	// 离所有观察者都很远且不活跃（普通移动或静止）
+	UPROPERTY(EditDefaultsOnly, Category="Network|Adaptive", meta=(ClampMin="1.0"))
+	float FarNetUpdateFrequency = 5.0f;
+
+	// 超过该水平速度视为高速移动
+	UPROPERTY(EditDefaultsOnly, Category="Network|Adaptive")
+	float FastMoveSpeedThreshold = 300.0f;
+
+	// 与最近的其他玩家距离超过该值视为“远离观察者”
+	UPROPERTY(EditDefaultsOnly, Category="Network|Adaptive")
+	float FarViewerDistance = 5000.0f;
+
+	// 开火等活动之后保持高频的时间（秒）
+	UPROPERTY(EditDefaultsOnly, Category="Network|Adaptive")
+	float NetActivityHoldTime = 0.5f;
+
+	// 频率重新评估的间隔（秒），避免每帧遍历所有玩家
+	UPROPERTY(EditDefaultsOnly, Category="Network|Adaptive")
+	float NetFrequencyEvalInterval = 0.25f;
+
+	// 子类在开火等需要高频复制的事件发生时调用（服务器）
+	void MarkNetActivity();
+
+	void UpdateAdaptiveNetFrequency(float DeltaTime);
+	float ComputeDesiredNetUpdateFrequency() const;
+	bool IsFarFromAllViewers() const;
+
+private:
+	void TickFixedSimulation(float DeltaTime);
+
+	// 切换移动组件由自身 Tick 还是由固定步驱动
+	void SetDriveMovementFixedStep(bool bDrive);
+
+	float SimTimeAccumulator = 0.0f;
+	bool bDrivingMovementFixedStep = false;
+
+	// 上一步/当前步的角色位置，用于 Mesh 的渲染插值
+	FVector PrevSimLocation = FVector::ZeroVector;
+	FVector SimLocation = FVector::ZeroVector;
+
+	// 插值位置相对当前模拟位置的偏移（世界空间）
+	FVector SimVisualOffset = FVector::ZeroVector;
+
+	// 上一步/当前步的地面速度，用于渲染插值
+	float PrevSimGroundSpeed = 0.0f;
+	float SimGroundSpeed = 0.0f;
+
+	float NetFrequencyEvalAccumulator = 0.0f;
+	double LastNetActivityTime = -1.0e9;
+
 public:
 	// Blueprint 只读访问接口，方便 AnimBP 或其他蓝图读取状态
 	UFUNCTION(BlueprintPure, Category="Movement|State")
@@ -41,4 +136,9 @@ public:
 
 	UFUNCTION(BlueprintPure, Category="Movement|State")
 	bool IsInAir() const { return bIsInAir; }
+
+	bool UsesFixedTickSimulation() const { return bUseFixedTickSimulation; }
+
+	// 固定步长模式下渲染插值的世界空间偏移，相机等挂在胶囊体上的表现需叠加此偏移
+	FVector GetSimVisualOffset() const { return SimVisualOffset; }
 };
@@ -0,0 +1,42 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Camera/PlayerCameraManager.h"
+#include "Character/PlayerCharacter.h"
+#include "MyPlayerCameraManager.generated.h"
+
+/**
+ * 相机模式栈：根据玩家角色当前的视角模式计算视图，并在模式切换时做时间混合。
+ * 各模式的视图直接由弹簧臂/插槽的现有变换计算，不改动组件的附着关系；
+ * 只有栈中的模式才会被计算，未激活的模式每帧没有开销。
+ */
+UCLASS()
+class DEMO_API AMyPlayerCameraManager : public APlayerCameraManager
+{
+	GENERATED_BODY()
+
+protected:
+	// 模式切换的混合时间（秒），0 表示立即切换
+	UPROPERTY(EditDefaultsOnly, Category="Camera", meta=(ClampMin="0.0"))
+	float CameraModeBlendTime = 0.25f;
+
+	virtual void UpdateViewTargetInternal(FTViewTarget& OutVT, float DeltaTime) override;
+
+private:
+	struct FCameraModeEntry
+	{
+		EViewMode Mode;
+		float BlendWeight;
+	};
+
+	// 栈底为最早的模式，栈顶为当前目标模式；栈顶混合完成后移除下面的模式
+	TArray<FCameraModeEntry> CameraModeStack;
+
+	// 栈所属的角色，视图目标变化时重置
+	TWeakObjectPtr<APlayerCharacter> StackOwner;
+
+	void PushCameraMode(EViewMode Mode);
+	void UpdateCameraModeStack(float DeltaTime);
+};
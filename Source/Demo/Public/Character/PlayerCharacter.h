@@ -9,6 +9,7 @@
 class USpringArmComponent;
 class UCameraComponent;
 class AGun;
+struct FMinimalViewInfo;
 
 UENUM(BlueprintType)
 enum class EViewMode : uint8
@@ -41,6 +42,14 @@ protected:
 	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category="Camera")
 	EViewMode CurrentViewMode = EViewMode::ThirdPerson;
 
+	// 弹簧臂停用期间相机延迟的目标位置不会更新，重新启用时先关闭延迟让其直接对齐，
+	// 到 CameraBoomLagRestoreFrame 之后再恢复原来的延迟设置
+	bool bRestoreCameraBoomLag = false;
+	bool bRestoreCameraBoomRotationLag = false;
+	uint64 CameraBoomLagRestoreFrame = 0;
+
+	void RestoreCameraBoomLag();
+
 	// ========= 玩家专用：输入与视角状态 =========
 	// 最近一帧输入方向（用于移动/动画）
 	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category="Movement|State")
@@ -54,6 +63,27 @@ protected:
 	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category="Camera|State")
 	float VerticalAngle = 0.0f;
 
+	// ========= 固定步长模拟：输入采样与插值 =========
+	// 控制器本帧写入的输入，同一帧内的每个模拟步都采样它；本帧至少有一步采样后在帧末清零
+	FVector2D PendingMoveInput = FVector2D::ZeroVector;
+
+	// 当前模拟步采样到的输入
+	FVector2D SampledMoveInput = FVector2D::ZeroVector;
+
+	bool bPendingMoveInputSampled = false;
+
+	// 上一步/当前步的视角角度，用于渲染插值
+	float PrevSimHorizontalAngle = 0.0f;
+	float PrevSimVerticalAngle = 0.0f;
+	float SimHorizontalAngle = 0.0f;
+	float SimVerticalAngle = 0.0f;
+
+	virtual void SimulateFixedStep(float FixedDeltaTime) override;
+	virtual void InterpolateSimState(float Alpha) override;
+
+	// 计算控制器旋转相对角色旋转的偏差角度
+	bool ComputeViewAngles(float& OutHorizontal, float& OutVertical) const;
+
 	// ========= 简易射击实现 =========
 	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category="Weapon|Debug")
 	float SimpleFireMaxRange = 10000.0f;
@@ -66,14 +96,34 @@ protected:
 	UPROPERTY(EditDefaultsOnly, Category="Weapon")
 	TSubclassOf<AGun> DefaultGunClass;
 
-	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category="Weapon")
+	// 枪由服务器生成并通过角色复制，客户端在 OnRep 中自行初始化并附着。
+	// 注意：枪自身的 AttachmentReplication 仍会在其通道上复制（休眠期间不发送），
+	// 要完全关闭需在 AGun::PreReplication 中处理
+	// 客户端开火时仍在本地调用 AGun::StartFire（开火表现），权威开火经由角色 RPC 在服务器执行
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, ReplicatedUsing=OnRep_CurrentGun, Category="Weapon")
 	AGun* CurrentGun = nullptr;
 
+	UFUNCTION()
+	void OnRep_CurrentGun();
+
+	// 装备枪：附着到 Mesh 后让枪进入网络休眠，之后只在弹药/状态/装备变化时唤醒
+	void EquipGun(AGun* NewGun);
+	void AttachGunToMesh(AGun* Gun) const;
+
+	// 客户端开火：经由角色的 RPC 转发，枪处于休眠时其自身通道已关闭，无法直接发送 Server RPC
+	UFUNCTION(Server, Reliable)
+	void Server_StartFireCurrentGun();
+	void StartFireCurrentGun_Internal();
+
 	virtual void BeginPlay() override;
+	virtual void GetLifetimeReplicatedProps(TArray<FLifetimeProperty>& OutLifetimeProps) const override;
 
 public:
 	// 输入处理
 	void HandleMoveInput(const FVector2D& InputAxis);
+
+	// 固定步长模式下由控制器调用：只记录输入，等待下一个模拟步采样
+	void QueueMoveInput(const FVector2D& InputAxis) { PendingMoveInput = InputAxis; }
 	void HandleJumpStarted();
 	void HandleJumpStopped();
 
@@ -89,6 +139,15 @@ public:
 	UFUNCTION(BlueprintCallable, Category="Camera")
 	void ToggleViewMode();
 
+	UFUNCTION(BlueprintPure, Category="Camera")
+	EViewMode GetViewMode() const { return CurrentViewMode; }
+
+	// 由 AMyPlayerCameraManager 调用：按指定模式计算视图，只读取现有组件/插槽变换
+	void ComputeCameraModeView(EViewMode Mode, float DeltaTime, FMinimalViewInfo& OutPOV) const;
+
+	// 由 AMyPlayerCameraManager 调用：模式进入/离开相机栈时启用或停用其专用组件
+	void SetCameraModeActive(EViewMode Mode, bool bActive);
+
 	// 视角角度的 Blueprint 访问接口（可用于动画蓝图或 UI）
 	UFUNCTION(BlueprintPure, Category="Camera|State")
 	float GetHorizontalAngle() const { return HorizontalAngle; }
@@ -13,4 +13,36 @@ class DEMO_API AMyGameMode : public AGameMode
 public:
 	AMyGameMode();
 	// 备注：通过构造函数设置默认 Pawn 和 PlayerController，便于在 C++ 层面保证默认类型并支持蓝图覆盖
+
+protected:
+	// ========= 对局回放录制（仅专用服务器） =========
+	// 录制流写到本地 Saved/Demos 目录（LocalFileNetworkReplayStreaming）。
+
+	// 是否在对局开始时自动录制回放
+	UPROPERTY(EditDefaultsOnly, Category="Replay")
+	bool bRecordMatchReplay = true;
+
+	// 检查点间隔（秒）：越短拖动/跳转越快，但录制时写检查点的开销和文件体积越大
+	UPROPERTY(EditDefaultsOnly, Category="Replay", meta=(ClampMin="5.0"))
+	float ReplayCheckpointInterval = 60.0f;
+
+	// 纯表现类 Actor（特效、装饰物等）不写入回放流
+	UPROPERTY(EditDefaultsOnly, Category="Replay")
+	TArray<TSubclassOf<AActor>> ReplayExcludedActorClasses;
+
+	virtual void HandleMatchHasStarted() override;
+	virtual void HandleMatchHasEnded() override;
+	virtual void EndPlay(const EEndPlayReason::Type EndPlayReason) override;
+
+	void StartMatchReplay();
+	void StopMatchReplay();
+
+	// 新生成的 Actor 如果属于排除列表，则关闭其回放相关性
+	void OnActorSpawnedForReplay(AActor* Actor);
+	void ApplyReplayFilter(AActor* Actor) const;
+
+private:
+	FDelegateHandle ActorSpawnedHandle;
+	FString ActiveReplayName;
+	double ReplayStartTime = 0.0;
 };